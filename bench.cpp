@@ -0,0 +1,127 @@
+// Measures the bulk byte order conversion throughput in regular and streaming mode,
+// and how much each of them slows down a cache-sensitive workload that's running
+// concurrently on another thread.
+//
+// Build with e.g.: g++ -std=c++11 -O2 -pthread bench.cpp -o bench
+// Usage: ./bench [buffer size in MiB] [hot working set size in KiB]
+
+#include "endian.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+enum class mode { idle, regular, streaming };
+
+const char* name(mode m)
+{
+    switch(m)
+    {
+    case mode::idle: return "idle";
+    case mode::regular: return "regular";
+    case mode::streaming: return "streaming";
+    }
+    return "";
+}
+
+double seconds_since(clock::time_point start)
+{
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+/**
+ * Chases pointers through a randomly permuted working set that fits in the cache
+ * until `stop` is set, returning the number of hops made per second. This slows
+ * down considerably if the working set is evicted from the cache.
+ */
+double chase(const std::vector<uint32_t>& next, const std::atomic<bool>& stop)
+{
+    const auto start = clock::now();
+    uint64_t hops = 0;
+    uint32_t i = 0;
+    while(!stop.load(std::memory_order_relaxed))
+    {
+        for(int j = 0; j < 1024; ++j) { i = next[i]; }
+        hops += 1024;
+    }
+    // Keep `i` alive so that the loop isn't optimized away.
+    if(i == uint32_t(-1)) { std::printf("unreachable\n"); }
+    return hops / seconds_since(start);
+}
+
+std::vector<uint32_t> make_working_set(size_t size)
+{
+    // Sattolo's algorithm, so that the permutation is a single cycle.
+    std::vector<uint32_t> next(size);
+    for(size_t i = 0; i < size; ++i) { next[i] = uint32_t(i); }
+    for(size_t i = size - 1; i > 0; --i)
+    {
+        const size_t j = size_t(std::rand()) % i;
+        std::swap(next[i], next[j]);
+    }
+    return next;
+}
+
+void run(mode m, const std::vector<uint32_t>& in, std::vector<uint32_t>& out,
+    const std::vector<uint32_t>& working_set)
+{
+    std::atomic<bool> stop(false);
+    double hops_per_sec = 0;
+    std::thread chaser([&] { hops_per_sec = chase(working_set, stop); });
+
+    const auto start = clock::now();
+    size_t rounds = 0;
+    do
+    {
+        if(m == mode::regular)
+            endian::reverse(in.data(), in.size(), out.data(), size_t(-1));
+        else if(m == mode::streaming)
+            endian::reverse_streaming(in.data(), in.size(), out.data());
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++rounds;
+    }
+    while(seconds_since(start) < 2.0);
+    const double elapsed = seconds_since(start);
+
+    stop = true;
+    chaser.join();
+
+    const double bytes = double(rounds) * in.size() * sizeof(uint32_t);
+    if(m == mode::idle)
+        std::printf("%-10s %12s", name(m), "-");
+    else
+        std::printf("%-10s %9.2f GB/s", name(m), bytes / elapsed / 1e9);
+    std::printf(" %12.1f Mhops/s\n", hops_per_sec / 1e6);
+}
+
+} // bench
+
+int main(int argc, char** argv)
+{
+    const size_t buffer_mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    const size_t working_set_kib = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1024;
+    if(buffer_mib == 0 || working_set_kib == 0)
+    {
+        std::fprintf(stderr, "buffer and working set sizes must be positive\n");
+        return 1;
+    }
+
+    std::vector<uint32_t> in(buffer_mib * 1024 * 1024 / sizeof(uint32_t));
+    std::vector<uint32_t> out(in.size());
+    for(size_t i = 0; i < in.size(); ++i) { in[i] = uint32_t(i); }
+    const auto working_set = bench::make_working_set(
+        working_set_kib * 1024 / sizeof(uint32_t));
+
+    std::printf("buffer: %zu MiB, working set: %zu KiB\n", buffer_mib, working_set_kib);
+    std::printf("%-10s %17s %20s\n", "mode", "conversion", "concurrent workload");
+    bench::run(bench::mode::idle, in, out, working_set);
+    bench::run(bench::mode::regular, in, out, working_set);
+    bench::run(bench::mode::streaming, in, out, working_set);
+}
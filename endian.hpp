@@ -126,10 +126,28 @@ constexpr uint64_t swap_u64(uint64_t n) noexcept
 # define MND_BYTE_SWAP_64(x) endian::detail::swap_u64(static_cast<uint64_t>(x))
 #endif
 
+// SSE2 is used for the bulk conversion of buffers. It's part of the x86-64
+// baseline, so in practice this only excludes 32-bit x86 built without it and
+// non-x86 platforms, where bulk conversion falls back to scalar loops.
+#if defined(__SSE2__) \
+ || defined(_M_X64) \
+ || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define MND_HAS_SSE2
+# include <emmintrin.h>
+#endif
+
+// Buffers of at least this many bytes are converted in streaming mode by the
+// bulk conversion functions, unless a threshold is passed explicitly. This
+// should be roughly the size of the last-level cache.
+#ifndef MND_STREAMING_THRESHOLD
+# define MND_STREAMING_THRESHOLD (8u * 1024u * 1024u)
+#endif
+
 // -- type traits
 
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
 
 namespace endian {
 namespace detail {
@@ -367,6 +385,40 @@ MND_CONSTEXPR void write_be(const T& h, OutputIt it) noexcept
 template<class T>
 MND_CONSTEXPR T reverse(const T& t);
 
+/**
+ * The default buffer size in bytes from which the bulk conversion functions switch
+ * to streaming mode. Set with the `MND_STREAMING_THRESHOLD` macro.
+ */
+constexpr size_t streaming_threshold = MND_STREAMING_THRESHOLD;
+
+/**
+ * Reverses the byte order of each of the `n` elements of `in`, writing the results
+ * to `out`. `in` and `out` may point to the same buffer, but must not otherwise
+ * overlap.
+ *
+ * If the buffer is at least `threshold` bytes large, the conversion is done by
+ * `reverse_streaming`, so that converting buffers larger than the last-level cache
+ * doesn't evict the rest of the program's working set. E.g.:
+ * ```
+ * std::vector<uint32_t> samples(64 * 1024 * 1024);
+ * // Read big endian samples from disk.
+ * // ...
+ * endian::reverse(samples.data(), samples.size(), samples.data());
+ * ```
+ */
+template<class T>
+void reverse(const T* in, size_t n, T* out,
+    size_t threshold = streaming_threshold) noexcept;
+
+/**
+ * Same as the bulk `reverse`, but the source is always prefetched ahead of the
+ * conversion and the results are written with non-temporal stores that bypass the
+ * cache. This is slower than a regular conversion for buffers that fit in the cache,
+ * and falls back to it on platforms without SSE2.
+ */
+template<class T>
+void reverse_streaming(const T* in, size_t n, T* out) noexcept;
+
 #ifndef MND_UNKNOWN_ENDIANNESS
 /// These are only available if your platform has a defined endianness.
 /**
@@ -376,6 +428,16 @@ MND_CONSTEXPR T reverse(const T& t);
 template<order Order, class T>
 MND_CONSTEXPR T conditional_convert(const T& t) noexcept;
 
+/**
+ * Conditionally converts each of the `n` elements of `in` to the specified
+ * endianness, writing the results to `out`. If the host's byte order is `Order`,
+ * this is a plain copy. Otherwise, it's the same as the bulk `reverse`, including
+ * switching to streaming mode for buffers of at least `threshold` bytes.
+ */
+template<order Order, class T>
+void conditional_convert(const T* in, size_t n, T* out,
+    size_t threshold = streaming_threshold) noexcept;
+
 /**
  * Conditionally converts to network byte order if and only if the host's byte order is
  * different from the network byte order.
@@ -409,6 +471,60 @@ MND_CONSTEXPR T host_to_network(const T& t);
  */
 template<class T>
 MND_CONSTEXPR T network_to_host(const T& t);
+
+/** The result of transcoding a UTF-16 or UTF-32 buffer to host byte order. */
+struct transcode_result
+{
+    /// The byte order of the input: the one given by its byte order mark, or the
+    /// fallback order if it had none.
+    order detected_order;
+    /// The number of bytes the byte order mark took up at the start of the input:
+    /// 0 if there was none, 2 for UTF-16, and 4 for UTF-32.
+    size_t bom_size;
+    /// The number of code units written to the output.
+    size_t count;
+    /// Whether the input is well-formed. Always true if validation wasn't requested.
+    bool valid;
+    /// If the input is not well-formed, the index in the output of the first invalid
+    /// code unit: an unpaired high or low surrogate, or for UTF-32, a code point that
+    /// isn't a Unicode scalar value.
+    size_t error_index;
+};
+
+/**
+ * Converts UTF-16 text in `in` of `size` bytes to host byte order, writing the code
+ * units to `out`, which must have space for `size / 2` of them.
+ *
+ * If the input starts with a byte order mark, it's used to determine the input's
+ * byte order and isn't written to `out`. Otherwise the input is assumed to be in
+ * `fallback` order, which per the Unicode standard is big endian. A trailing odd
+ * byte is ignored.
+ *
+ * If `validate` is set, it's also checked in the same pass that surrogates come in
+ * high-low pairs. E.g.:
+ * ```
+ * std::vector<char> text;
+ * // Read UTF-16 text of unknown byte order.
+ * // ...
+ * std::u16string units(text.size() / 2, u'\0');
+ * const auto res = endian::utf16_to_host(text.data(), text.size(), &units[0],
+ *     endian::order::big, true);
+ * units.resize(res.count);
+ * ```
+ */
+inline transcode_result utf16_to_host(const char* in, size_t size, char16_t* out,
+    order fallback = order::big, bool validate = false) noexcept;
+
+/**
+ * Converts UTF-32 text in `in` of `size` bytes to host byte order, writing the code
+ * points to `out`, which must have space for `size / 4` of them.
+ *
+ * Byte order marks are handled the same way as in `utf16_to_host`. If `validate` is
+ * set, it's also checked that each code point is a Unicode scalar value, i.e. that
+ * it's at most U+10FFFF and not a surrogate.
+ */
+inline transcode_result utf32_to_host(const char* in, size_t size, char32_t* out,
+    order fallback = order::big, bool validate = false) noexcept;
 #endif // MND_UNKNOWN_ENDIANNESS
 
 } // endian
@@ -506,6 +622,169 @@ struct byte_swapper<8>
 
 // --
 
+#ifdef MND_HAS_SSE2
+/** Reverses the byte order of each `Size` byte element in a 16 byte vector. */
+template<size_t Size>
+struct simd_byte_swapper {};
+
+template<>
+struct simd_byte_swapper<2>
+{
+    __m128i operator()(__m128i v) { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+};
+
+template<>
+struct simd_byte_swapper<4>
+{
+    __m128i operator()(__m128i v)
+    {
+        // Swap the 16-bit halves of each element, then the bytes of each half.
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return simd_byte_swapper<2>()(v);
+    }
+};
+
+template<>
+struct simd_byte_swapper<8>
+{
+    __m128i operator()(__m128i v)
+    {
+        // Reverse the 16-bit quarters of each element, then the bytes of each quarter.
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return simd_byte_swapper<2>()(v);
+    }
+};
+
+template<bool Swap, size_t Size>
+struct simd_converter
+{
+    __m128i operator()(__m128i v) { return simd_byte_swapper<Size>()(v); }
+};
+
+template<size_t Size>
+struct simd_converter<false, Size>
+{
+    __m128i operator()(__m128i v) { return v; }
+};
+#endif // MND_HAS_SSE2
+
+/**
+ * Reverses the bytes of `t` through an integer of the same size, so that elements
+ * that aren't integers, e.g. floats, have their bytes swapped rather than their
+ * values converted, same as in the vector loops.
+ */
+template<bool Swap>
+struct bulk_converter
+{
+    template<class T>
+    T operator()(const T& t)
+    {
+        typename integral_type_for<sizeof(T)>::type n;
+        std::memcpy(&n, &t, sizeof n);
+        n = reverse(n);
+        T r;
+        std::memcpy(&r, &n, sizeof r);
+        return r;
+    }
+};
+
+template<>
+struct bulk_converter<false>
+{
+    template<class T>
+    T operator()(const T& t) { return t; }
+};
+
+/** How many bytes ahead of the conversion the source is prefetched in streaming mode. */
+constexpr size_t prefetch_distance = 512;
+
+/** Converts `n` elements of `in` to `out`, reversing them if `Swap` is set. */
+template<bool Swap, class T>
+void convert(const T* in, size_t n, T* out) noexcept
+{
+    static_assert(!Swap || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+        "Can only reverse elements of 2, 4, or 8 bytes");
+    if(!Swap && in == out) { return; }
+    for(size_t i = 0; i < n; ++i)
+    {
+        out[i] = bulk_converter<Swap>()(in[i]);
+    }
+}
+
+/**
+ * Same as `convert`, but prefetches `in` and writes `out` with non-temporal stores,
+ * so that neither buffer is brought into the cache.
+ */
+template<bool Swap, class T>
+void stream_convert(const T* in, size_t n, T* out) noexcept
+{
+    static_assert(!Swap || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+        "Can only reverse elements of 2, 4, or 8 bytes");
+    static_assert(16 % sizeof(T) == 0,
+        "Can only stream elements of 1, 2, 4, 8, or 16 bytes");
+    if(!Swap && in == out) { return; }
+    size_t i = 0;
+#ifdef MND_HAS_SSE2
+    // Streaming stores need a 16 byte aligned destination, which can only be
+    // reached if `out` is at least aligned to the element size.
+    if(reinterpret_cast<uintptr_t>(out) % sizeof(T) == 0)
+    {
+        for(; i < n && reinterpret_cast<uintptr_t>(out + i) % 16 != 0; ++i)
+        {
+            out[i] = bulk_converter<Swap>()(in[i]);
+        }
+
+        // Convert a cache line at a time, so that each line is only prefetched once.
+        const size_t per_vector = 16 / sizeof(T);
+        for(; i + 4 * per_vector <= n; i += 4 * per_vector)
+        {
+            const char* src = reinterpret_cast<const char*>(in + i);
+            __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+            // Don't form a pointer past the end of `in`.
+            if((n - i) * sizeof(T) > prefetch_distance)
+            {
+                _mm_prefetch(src + prefetch_distance, _MM_HINT_NTA);
+            }
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+            const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+            _mm_stream_si128(dst, simd_converter<Swap, sizeof(T)>()(v0));
+            _mm_stream_si128(dst + 1, simd_converter<Swap, sizeof(T)>()(v1));
+            _mm_stream_si128(dst + 2, simd_converter<Swap, sizeof(T)>()(v2));
+            _mm_stream_si128(dst + 3, simd_converter<Swap, sizeof(T)>()(v3));
+        }
+        for(; i + per_vector <= n; i += per_vector)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(out + i),
+                simd_converter<Swap, sizeof(T)>()(v));
+        }
+        // Non-temporal stores are weakly ordered, so make them visible before
+        // returning to the caller.
+        _mm_sfence();
+    }
+#endif // MND_HAS_SSE2
+    for(; i < n; ++i)
+    {
+        out[i] = bulk_converter<Swap>()(in[i]);
+    }
+}
+
+/** Converts in streaming mode if the buffer is at least `threshold` bytes large. */
+template<bool Swap, class T>
+void bulk_convert(const T* in, size_t n, T* out, size_t threshold) noexcept
+{
+    if(n * sizeof(T) >= threshold)
+        stream_convert<Swap>(in, n, out);
+    else
+        convert<Swap>(in, n, out);
+}
+
+// --
+
 #ifndef MND_UNKNOWN_ENDIANNESS
 template<order Order>
 struct conditional_reverser
@@ -520,6 +799,154 @@ struct conditional_reverser<order::host>
     template<class T>
     MND_CONSTEXPR T operator()(const T& t) { return t; }
 };
+
+// --
+
+/** Checks that UTF-16 surrogates come in high-low pairs, one code unit at a time. */
+struct utf16_validator
+{
+    bool after_high = false;
+
+    bool operator()(char16_t c) noexcept
+    {
+        const bool is_low = (c & 0xfc00) == 0xdc00;
+        if(after_high != is_low) { return false; }
+        after_high = (c & 0xfc00) == 0xd800;
+        return true;
+    }
+
+    bool at_end() const noexcept { return !after_high; }
+
+    /**
+     * Returns the index of the invalid code unit, given the index `i` of the unit
+     * that was rejected. That is the preceding high surrogate if `i` isn't the low
+     * surrogate it expects.
+     */
+    size_t error_index(size_t i) const noexcept { return after_high ? i - 1 : i; }
+
+#ifdef MND_HAS_SSE2
+    /** Returns whether the vector of code units has to be checked one by one. */
+    bool needs_check(__m128i v) const noexcept
+    {
+        const __m128i surrogates = _mm_cmpeq_epi16(
+            _mm_and_si128(v, _mm_set1_epi16(short(0xf800))),
+            _mm_set1_epi16(short(0xd800)));
+        return after_high || _mm_movemask_epi8(surrogates) != 0;
+    }
+#endif // MND_HAS_SSE2
+};
+
+/** Checks that UTF-32 code points are Unicode scalar values. */
+struct utf32_validator
+{
+    bool operator()(char32_t c) const noexcept
+    {
+        return c <= 0x10ffff && (c & 0xfffff800) != 0xd800;
+    }
+
+    bool at_end() const noexcept { return true; }
+
+    size_t error_index(size_t i) const noexcept { return i; }
+
+#ifdef MND_HAS_SSE2
+    bool needs_check(__m128i v) const noexcept
+    {
+        const __m128i surrogates = _mm_cmpeq_epi32(
+            _mm_and_si128(v, _mm_set1_epi32(int(0xfffff800))),
+            _mm_set1_epi32(0xd800));
+        const __m128i too_large = _mm_cmpgt_epi32(
+            _mm_srli_epi32(v, 16), _mm_set1_epi32(0x10));
+        return _mm_movemask_epi8(_mm_or_si128(surrogates, too_large)) != 0;
+    }
+#endif // MND_HAS_SSE2
+};
+
+/**
+ * Converts the `count` code units of type `CharT` in `in` from `Order` to host byte
+ * order, optionally validating them with `Validator` in the same pass.
+ */
+template<order Order, class CharT, class Validator>
+void transcode_units(const char* in, size_t count, CharT* out, bool validate,
+    transcode_result& result) noexcept
+{
+    using uint_type = typename integral_type_for<sizeof(CharT)>::type;
+    Validator validator;
+    size_t i = 0;
+#ifdef MND_HAS_SSE2
+    const size_t per_vector = 16 / sizeof(CharT);
+    for(; i + per_vector <= count; i += per_vector)
+    {
+        const __m128i v = simd_converter<Order != order::host, sizeof(CharT)>()(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * sizeof(CharT))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        if(validate && validator.needs_check(v))
+        {
+            for(size_t j = i; j < i + per_vector; ++j)
+            {
+                if(!validator(out[j]))
+                {
+                    result.valid = false;
+                    result.error_index = validator.error_index(j);
+                    validate = false;
+                    break;
+                }
+            }
+        }
+    }
+#endif // MND_HAS_SSE2
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<CharT>(read<Order, uint_type>(in + i * sizeof(CharT)));
+        if(validate && !validator(out[i]))
+        {
+            result.valid = false;
+            result.error_index = validator.error_index(i);
+            validate = false;
+        }
+    }
+    if(validate && !validator.at_end())
+    {
+        result.valid = false;
+        result.error_index = validator.error_index(count);
+    }
+}
+
+/**
+ * Detects the byte order mark `bom_be` or its reverse at the start of `in`, then
+ * converts the rest of the input to host byte order.
+ */
+template<class CharT, class Validator>
+transcode_result detect_bom_and_transcode(const char* in, size_t size, CharT* out,
+    const unsigned char (&bom_be)[sizeof(CharT)], order fallback, bool validate) noexcept
+{
+    transcode_result result = { fallback, 0, 0, true, 0 };
+    if(size >= sizeof(CharT))
+    {
+        bool is_be = true;
+        bool is_le = true;
+        for(size_t i = 0; i < sizeof(CharT); ++i)
+        {
+            is_be = is_be && static_cast<unsigned char>(in[i]) == bom_be[i];
+            is_le = is_le
+                && static_cast<unsigned char>(in[i]) == bom_be[sizeof(CharT) - 1 - i];
+        }
+        if(is_be || is_le)
+        {
+            result.detected_order = is_be ? order::big : order::little;
+            result.bom_size = sizeof(CharT);
+        }
+    }
+
+    in += result.bom_size;
+    result.count = (size - result.bom_size) / sizeof(CharT);
+    if(result.detected_order == order::big)
+        transcode_units<order::big, CharT, Validator>(
+            in, result.count, out, validate, result);
+    else
+        transcode_units<order::little, CharT, Validator>(
+            in, result.count, out, validate, result);
+    return result;
+}
 #endif // MND_UNKNOWN_ENDIANNESS
 
 } // detail
@@ -567,6 +994,18 @@ MND_CONSTEXPR T reverse(const T& t)
     return detail::byte_swapper<sizeof t>()(t);
 }
 
+template<class T>
+void reverse(const T* in, size_t n, T* out, size_t threshold) noexcept
+{
+    detail::bulk_convert<true>(in, n, out, threshold);
+}
+
+template<class T>
+void reverse_streaming(const T* in, size_t n, T* out) noexcept
+{
+    detail::stream_convert<true>(in, n, out);
+}
+
 #ifndef MND_UNKNOWN_ENDIANNESS
 template<order Order, class T>
 MND_CONSTEXPR T conditional_convert(const T& t) noexcept
@@ -574,6 +1013,12 @@ MND_CONSTEXPR T conditional_convert(const T& t) noexcept
     return detail::conditional_reverser<Order>()(t);
 }
 
+template<order Order, class T>
+void conditional_convert(const T* in, size_t n, T* out, size_t threshold) noexcept
+{
+    detail::bulk_convert<Order != order::host>(in, n, out, threshold);
+}
+
 template<class T>
 MND_CONSTEXPR T host_to_network(const T& t)
 {
@@ -587,6 +1032,22 @@ MND_CONSTEXPR T network_to_host(const T& t)
     // if the host's and network's byte orders differ.
     return host_to_network(t);
 }
+
+inline transcode_result utf16_to_host(const char* in, size_t size, char16_t* out,
+    order fallback, bool validate) noexcept
+{
+    static const unsigned char bom[] = { 0xfe, 0xff };
+    return detail::detect_bom_and_transcode<char16_t, detail::utf16_validator>(
+        in, size, out, bom, fallback, validate);
+}
+
+inline transcode_result utf32_to_host(const char* in, size_t size, char32_t* out,
+    order fallback, bool validate) noexcept
+{
+    static const unsigned char bom[] = { 0x00, 0x00, 0xfe, 0xff };
+    return detail::detect_bom_and_transcode<char32_t, detail::utf32_validator>(
+        in, size, out, bom, fallback, validate);
+}
 #endif // MND_UNKNOWN_ENDIANNESS
 
 } // endian
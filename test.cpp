@@ -1,6 +1,8 @@
 #include "endian.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <typeinfo>
 
 namespace test {
@@ -53,6 +55,183 @@ void reverse()
     assert(conv == orig);
 }
 
+template<class T> void bulk_reverse()
+{
+    // Enough elements to cover the unaligned head, the per cache line and per
+    // vector loops, and the scalar tail of streaming mode.
+    const size_t n = 103;
+    T in[n + 1];
+    T out[n + 1];
+    for(size_t i = 0; i < n + 1; ++i)
+        in[i] = static_cast<T>(0x0102030405060708ull * (i + 1));
+
+    // Check both an aligned and a misaligned destination, in both modes.
+    for(size_t offset = 0; offset < 2; ++offset)
+    {
+        endian::reverse(in, n, out + offset, 0);
+        for(size_t i = 0; i < n; ++i)
+            assert(out[i + offset] == endian::reverse(in[i]));
+
+        endian::reverse(in, n, out + offset, size_t(-1));
+        for(size_t i = 0; i < n; ++i)
+            assert(out[i + offset] == endian::reverse(in[i]));
+    }
+
+    // In place.
+    std::copy(in, in + n, out);
+    endian::reverse_streaming(out, n, out);
+    for(size_t i = 0; i < n; ++i)
+        assert(out[i] == endian::reverse(in[i]));
+}
+
+void bulk_reverse_float()
+{
+    // Floats must have their bytes swapped in both modes, not their values
+    // converted to integers.
+    const size_t n = 67;
+    float in[n];
+    float regular[n + 1];
+    float streaming[n + 1];
+    for(size_t i = 0; i < n; ++i)
+        in[i] = 0.75f + float(i);
+
+    for(size_t offset = 0; offset < 2; ++offset)
+    {
+        endian::reverse(in, n, regular + offset, size_t(-1));
+        endian::reverse(in, n, streaming + offset, 0);
+        for(size_t i = 0; i < n; ++i)
+        {
+            uint32_t expected;
+            std::memcpy(&expected, &in[i], sizeof expected);
+            expected = endian::reverse(expected);
+            assert(std::memcmp(&regular[i + offset], &expected, sizeof expected) == 0);
+            assert(std::memcmp(&streaming[i + offset], &expected, sizeof expected) == 0);
+        }
+    }
+}
+
+void bulk_conditional_convert()
+{
+    uint32_t in[40];
+    uint32_t out[40];
+    for(size_t i = 0; i < 40; ++i)
+        in[i] = static_cast<uint32_t>(i * 0x01020304);
+
+    endian::conditional_convert<endian::order::network>(in, 40, out, 0);
+    for(size_t i = 0; i < 40; ++i)
+        assert(out[i] == endian::host_to_network(in[i]));
+
+    endian::conditional_convert<endian::order::host>(in, 40, out, 0);
+    for(size_t i = 0; i < 40; ++i)
+        assert(out[i] == in[i]);
+}
+
+/** Writes `n` UTF-16 code units to `buffer` in `Order`, after a byte order mark. */
+template<endian::order Order>
+void write_utf16(const char16_t* text, size_t n, char* buffer)
+{
+    endian::write<Order>(uint16_t(0xfeff), buffer);
+    for(size_t i = 0; i < n; ++i)
+        endian::write<Order>(uint16_t(text[i]), buffer + 2 + 2 * i);
+}
+
+/** Returns the index of the first invalid code unit in `text`, or -1 if it's valid. */
+int validate_utf16(const char16_t* text, size_t n)
+{
+    char buffer[2 + 2 * 32];
+    char16_t out[32];
+    assert(n <= 32);
+    write_utf16<endian::order::big>(text, n, buffer);
+    const auto res = endian::utf16_to_host(buffer, 2 + 2 * n, out,
+        endian::order::big, true);
+    assert(res.count == n && std::equal(out, out + n, text));
+    return res.valid ? -1 : int(res.error_index);
+}
+
+void utf16_to_host()
+{
+    // 21 code units, so that both the vector and scalar loops are used, with a
+    // surrogate pair straddling the two.
+    const char16_t text[] = u"h\u00e9llo, worlds! \U0001f600 bye";
+    const size_t n = sizeof(text) / sizeof(char16_t) - 1;
+    assert(n == 21 && text[15] == 0xd83d);
+    char be[2 + 2 * n];
+    char le[2 + 2 * n];
+    write_utf16<endian::order::big>(text, n, be);
+    write_utf16<endian::order::little>(text, n, le);
+
+    char16_t out[n];
+    auto res = endian::utf16_to_host(be, sizeof be, out, endian::order::little, true);
+    assert(res.detected_order == endian::order::big);
+    assert(res.bom_size == 2 && res.count == n && res.valid);
+    assert(std::equal(out, out + n, text));
+
+    res = endian::utf16_to_host(le, sizeof le, out, endian::order::big, true);
+    assert(res.detected_order == endian::order::little);
+    assert(res.bom_size == 2 && res.count == n && res.valid);
+    assert(std::equal(out, out + n, text));
+
+    // Without a BOM, the fallback order is used.
+    res = endian::utf16_to_host(le + 2, sizeof le - 2, out, endian::order::little);
+    assert(res.detected_order == endian::order::little);
+    assert(res.bom_size == 0 && res.count == n);
+    assert(std::equal(out, out + n, text));
+
+    // Validation is off by default.
+    const char16_t lone_low[] = { 'a', 0xdc00, 'b' };
+    write_utf16<endian::order::big>(lone_low, 3, be);
+    res = endian::utf16_to_host(be, 2 + 2 * 3, out);
+    assert(res.valid);
+
+    // Invalid code units are reported at their own index, whether they're found
+    // in the vector or in the scalar loop.
+    const char16_t a = 'a';
+    const char16_t hi = 0xd83d;
+    const char16_t lo = 0xde00;
+    const char16_t lone_low_in_vector[] = { a, a, a, lo, a, a, a, a, a };
+    assert(validate_utf16(lone_low_in_vector, 9) == 3);
+    const char16_t lone_high_in_vector[] = { a, a, a, hi, a, a, a, a, a };
+    assert(validate_utf16(lone_high_in_vector, 9) == 3);
+    const char16_t lone_high_before_tail[] = { a, a, a, a, a, a, a, hi, a, a };
+    assert(validate_utf16(lone_high_before_tail, 10) == 7);
+    const char16_t lone_high_in_tail[] = { a, a, a, a, a, a, a, a, hi, a, a };
+    assert(validate_utf16(lone_high_in_tail, 11) == 8);
+    const char16_t lone_low_in_tail[] = { a, a, a, a, a, a, a, a, a, lo, a };
+    assert(validate_utf16(lone_low_in_tail, 11) == 9);
+    const char16_t swapped_pair[] = { a, a, a, a, a, a, a, a, lo, hi, a };
+    assert(validate_utf16(swapped_pair, 11) == 8);
+    const char16_t high_at_end[] = { a, a, a, a, a, a, a, a, hi };
+    assert(validate_utf16(high_at_end, 9) == 8);
+    const char16_t high_at_vector_end[] = { a, a, a, a, a, a, a, hi };
+    assert(validate_utf16(high_at_vector_end, 8) == 7);
+    const char16_t pairs[] = { a, a, a, a, a, a, a, hi, lo, hi, lo, a };
+    assert(validate_utf16(pairs, 12) == -1);
+}
+
+void utf32_to_host()
+{
+    const char32_t text[] = U"h\u00e9llo, \U0001f600 world!";
+    const size_t n = sizeof(text) / sizeof(char32_t) - 1;
+    char le[4 + 4 * n];
+    endian::write<endian::order::little>(uint32_t(0xfeff), le);
+    for(size_t i = 0; i < n; ++i)
+        endian::write<endian::order::little>(uint32_t(text[i]), le + 4 + 4 * i);
+
+    char32_t out[n];
+    auto res = endian::utf32_to_host(le, sizeof le, out, endian::order::big, true);
+    assert(res.detected_order == endian::order::little);
+    assert(res.bom_size == 4 && res.count == n && res.valid);
+    assert(std::equal(out, out + n, text));
+
+    endian::write<endian::order::little>(uint32_t(0x110000), le + 4 + 4 * 5);
+    res = endian::utf32_to_host(le, sizeof le, out, endian::order::big, true);
+    assert(!res.valid && res.error_index == 5);
+
+    endian::write<endian::order::little>(uint32_t(0xdc00), le + 4 + 4 * 5);
+    res = endian::utf32_to_host(le, sizeof le, out, endian::order::big, true);
+    assert(!res.valid && res.error_index == 5);
+}
+
 void host_network_conv()
 {
     const uint32_t orig = 1234;
@@ -98,6 +277,15 @@ int main()
     test::reverse();
     test::host_network_conv();
 
+    test::bulk_reverse<uint16_t>();
+    test::bulk_reverse<uint32_t>();
+    test::bulk_reverse<uint64_t>();
+    test::bulk_reverse_float();
+    test::bulk_conditional_convert();
+
+    test::utf16_to_host();
+    test::utf32_to_host();
+
     if(endian::order::host == endian::order::little)
         std::printf("host is little endian\n");
     else